@@ -0,0 +1,140 @@
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include "catalog.h"
+#include "query.h"
+#include "workmem.h"
+
+// define if debug output wanted
+//#define DEBUGAGG
+
+
+const int AGGPARTS = 8;                 // # of spill partitions per level
+const int AGGMAXLEVEL = 6;              // max. depth of recursive spilling
+
+
+// AGGCOL describes one column of the result of an aggregate query.
+// Grouping columns (func == AGG_NONE) are copied out of the group
+// key; all other columns are computed from a running AGGSTATE that
+// is kept per group.
+
+typedef struct {
+  AggFunc func;                         // aggregate function
+  int inOffset;                         // offset of input attribute
+  int inLen;                            // length of input attribute
+  Datatype inType;                      // type of input attribute
+  int keyOffset;                        // offset in group key (AGG_NONE)
+  int stateOffset;                      // offset of running state
+  int outLen;                           // length of result attribute
+} AGGCOL;
+
+
+// Running state of one aggregate within one group. MIN and MAX
+// keep a copy of the current extreme value right behind the state.
+
+typedef struct {
+  long long cnt;                        // # of values folded in
+  double sum;                           // running sum (SUM, AVG)
+} AGGSTATE;
+
+
+// AggSpec holds everything the aggregation operators need to know
+// about the input and output of an aggregate query: how to build the
+// group key from an input tuple and how to fold an input tuple into
+// the running state of its group.
+
+class AggSpec {
+ public:
+  AggSpec(const int groupCnt, const AttrDesc groupAttrs[],
+	  const int colCnt, const AGGCOL cols[]);
+  ~AggSpec();
+
+  void makeKey(const Record & rec, char* key) const;  // group key of rec
+  void initState(char* state) const;                  // empty group
+  void fold(const Record & rec, char* state) const;   // add rec to group
+  void finish(const char* key, const char* state,
+	      char* outRec) const;                     // build result tuple
+
+  int keyLen;                           // length of the group key
+  int stateLen;                         // length of all running states
+  int outLen;                           // length of a result tuple
+  int groupCnt;                         // # of grouping attributes
+  AttrDesc* groupAttrs;                 // grouping attributes
+  int colCnt;                           // # of result columns
+  AGGCOL* cols;                         // result columns
+};
+
+
+// In-memory hash aggregation. Groups are kept in a chained hash
+// table whose entries (key followed by running state) are carved
+// out of large chunks. Once the table has used up its memory grant,
+// tuples that belong to groups not already in the table are spilled,
+// hash partitioned on the group key, into temporary heap files in
+// the same way Partition splits a file. emit() writes out the groups
+// held in memory and then aggregates each spill partition with a new
+// HashAggregate (using a different hash seed) one level down.
+
+class HashAggregate {
+ public:
+  HashAggregate(const AggSpec & spec,
+		MemGrant & grant,           // memory for the group table
+		const int level,            // recursion level (0 at top)
+		Status & status);
+  ~HashAggregate();
+
+  static int entryBytes(const AggSpec & spec); // memory cost of a group
+
+  Status insert(const Record & rec);    // fold one input tuple
+  Status emit(InsertFileScan* result, int & groups); // write all groups
+
+ private:
+  const unsigned int hash(const char* key) const;
+  Status spill(const Record & rec, const unsigned int h);
+
+  const AggSpec & spec;
+  MemGrant & grant;                     // memory for the group table
+  int level;
+  unsigned int seed;                    // hash seed of this level
+
+  int entryLen;                         // bytes per group entry
+  int htSize;                           // # of hash buckets (power of 2)
+  char** ht;                            // bucket heads
+  vector<char*> chunks;                 // storage for group entries
+  int chunkUsed;                        // bytes used in last chunk
+  int chunkLen;                         // size of last chunk in bytes
+  int maxEntries;                       // capacity within memory budget
+  int numEntries;                       // # of groups in memory
+
+  InsertFileScan** part;                // spill partitions, if any
+  string* partName;                     // names of spill partitions
+  int spilled;                          // # of tuples spilled
+};
+
+
+// Sort-based aggregation for input that arrives in group order
+// (e.g. from a SortedFile on the grouping attribute). Only the
+// current group is held in memory; it is written out as soon as a
+// tuple with a different key shows up.
+
+class SortAggregate {
+ public:
+  SortAggregate(const AggSpec & spec, InsertFileScan* result);
+  ~SortAggregate();
+
+  Status insert(const Record & rec);    // fold one input tuple
+  Status emit(int & groups);            // write out the last group
+
+ private:
+  Status flush();
+
+  const AggSpec & spec;
+  InsertFileScan* result;
+  char* curKey;                         // key of current group
+  char* newKey;                         // key of incoming tuple
+  char* state;                          // running state of current group
+  char* outRec;                         // result tuple buffer
+  bool valid;                           // true if a group is open
+  int groups;                           // # of groups written
+};
+
+#endif
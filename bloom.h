@@ -0,0 +1,45 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <sys/types.h>
+#include <stdint.h>
+
+
+const int BLOOMBITS = 10;               // bits per key wanted
+const int BLOOMPROBES = 6;              // bits set per key
+
+
+// A blocked Bloom filter: the bits of a key all fall into one block
+// the size of a cache line, chosen by the key's hash value, so that
+// adding or testing a key touches a single cache line. The filter
+// answers "maybe" for every key added and for a small fraction of
+// the others (about 1-2% at BLOOMBITS bits per key).
+//
+// Keys are given by a 32-bit hash value, which must be computed the
+// same way on both sides.
+
+class BloomFilter {
+ public:
+  BloomFilter(const int keys,           // # of keys to be added
+	      const int maxBytes);      // memory available
+  ~BloomFilter();
+
+  static int bytesFor(const int keys);  // size wanted for keys
+
+  void add(const unsigned int h);
+  bool mayContain(const unsigned int h) const;
+
+  int size() const { return numBlocks * sizeof(BLOCK); }
+
+ private:
+  typedef struct {
+    uint64_t words[8];                  // 512 bits, one cache line
+  } BLOCK;
+
+  BLOCK* block(const unsigned int h) const;
+
+  int numBlocks;
+  BLOCK* blocks;
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef BUF_H
 #define BUF_H
 
+#include <pthread.h>
+#include <map>
 #include "db.h"
 // define if debug output wanted
 //#define DEBUGBUF
@@ -55,6 +57,8 @@ private:
   bool 	dirty;	  // true if dirty;  false otherwise
   bool 	valid;   // true if page is valid
   bool  refbit;	 // has this buffer frame been reference recently
+  bool  writing;  // being written out by the background writer
+  LSN   lsn;      // log must be flushed up to here before writing
 
   void Clear() {  // initialize buffer frame for a new user
     	pinCnt = 0;
@@ -62,6 +66,8 @@ private:
 	pageNo = -1;
     	dirty = false;
 	valid = false;
+	writing = false;
+	lsn = 0;
   };
 
   void Set(File* filePtr, int pageNum) { 
@@ -71,6 +77,7 @@ private:
       dirty = false;
       valid = true;
       refbit = true;
+      lsn = 0;
   }
 
   BufDesc() {
@@ -79,20 +86,42 @@ private:
 };
 
 
+// how pages of database files get into the buffer pool
+enum IOMode { BUFFEREDIO,   // read and written through the OS page cache
+	      DIRECTIO,     // with O_DIRECT, bypassing the OS page cache
+	      MAPPEDIO };   // as BUFFEREDIO, but read-only pins of pages
+			    // not in the pool point into a file mapping
+
 struct BufStats
 {
   int accesses;    // Total number of accesses to buffer pool
   int diskreads;   // Number of pages read from disk (including allocs)
   int diskwrites;  // Number of pages written back to disk
+  int hits;        // Number of page requests found in the buffer pool
+  int misses;      // Number of page requests that had to read the page
+  int mapped;      // Number of page requests served from a file mapping
+  int writestalls; // Number of frame allocations that wrote a dirty page
+  int bgwrites;    // Number of pages written by the background writer
+  int syncscans;   // Number of scans that joined a scan in progress
+
+  // memory footprint, set when the pool is allocated (not cleared)
+  long poolBytes;  // Bytes mapped for the buffer pool frames
+  long descBytes;  // Bytes of frame descriptors and hash table
+  bool hugePages;  // Pool is backed by huge pages
+  IOMode ioMode;   // How files are read and written
 
   void clear()
     {
-      accesses = diskreads = diskwrites = 0;
+      accesses = diskreads = diskwrites = hits = misses = mapped = 0;
+      writestalls = bgwrites = syncscans = 0;
     }
       
   BufStats()
     {
       clear();
+      poolBytes = descBytes = 0;
+      hugePages = false;
+      ioMode = BUFFEREDIO;
     }
 };
 
@@ -105,6 +134,34 @@ private:
   BufHashTbl*    hashTable;  	// hash table mapping (File, page) to frame
   BufDesc*	 bufTable;  	// vector of status info, 1 per page
   BufStats	 bufStats;	// buffer pool statistics
+  size_t	 mapBytes;	// length of the mapping holding bufPool
+
+  // The background writer thread writes out unpinned dirty frames
+  // ahead of the clock hand. It shares frame state with the methods
+  // below under latch; it writes copies of the pages, without latch.
+  pthread_mutex_t latch;	// protects frame state from the writer
+  pthread_cond_t writerWake;	// signalled when there may be work
+  pthread_cond_t writerIdle;	// signalled when a batch is written
+  pthread_t	 writer;
+  bool		 writerOn;	// writer thread is running
+  bool		 writerStop;	// writer thread is to exit
+  int		 writerAhead;	// # frames after the clock hand kept clean
+  int		 writerInFlight; // # frames of the batch being written
+  int		 allocsSinceSweep; // # frames allocated since last batch
+  Page*		 writerPages;	// copies of the pages being written
+
+  // Synchronized scans: for every file with scans in progress, how
+  // many there are and the page one of them has read last
+  struct ScanPos {
+    int scans;
+    int pageNo;
+  };
+  map<const File*, ScanPos> scanPos;
+
+  static void* writerMain(void* arg);
+  void runWriter();
+  void waitForWriter();		// latch held
+  const Status writeFrame(const int frameNo); // latch held
 
   const Status allocBuf(int & frame);   // allocate a free frame.  
   const void releaseBuf(int frame); // return unused frame to end of list
@@ -117,17 +174,43 @@ private:
 public:
   Page*	         bufPool;   // actual buffer pool
 
-  BufMgr(const int bufs);
+  // In DIRECTIO mode files are opened with O_DIRECT so that pages are
+  // cached only in the buffer pool and not also by the OS.
+  BufMgr(const int bufs, const IOMode mode = BUFFEREDIO);
   ~BufMgr();
 
   const Status readPage(File* file, const int PageNo, Page*& page);
-  const Status unPinPage(File* file, const int PageNo, const bool dirty);
+  // lsn is that of the last logged change to the page (see LogMgr)
+  const Status unPinPage(File* file, const int PageNo, const bool dirty,
+			 const LSN lsn = 0);
+
+  // Pin a page that will only be read. In MAPPEDIO mode a page that
+  // is not in the buffer pool is not copied into a frame: page points
+  // into a read-only mapping of the file and mapped is set. Such a
+  // page is released with unPinMapped() and must not be modified.
+  const Status readPageMapped(File* file, const int PageNo, Page*& page,
+			      bool & mapped);
+  const Status unPinMapped(File* file, const int PageNo);
   const Status allocPage(File* file, int& PageNo, Page*& page); 
                         // allocates a new, empty page 
   const Status flushFile(const File* file); // writing out all dirty pages of the file
   const Status disposePage(File* file, const int PageNo); // dispose of page in file
+  const Status writeAll(); // write all dirty and pinned pages
   void  printSelf();
 
+  // Start the background writer, keeping the ahead frames that follow
+  // the clock hand clean. Returns false if it could not be started.
+  bool startWriter(const int ahead);
+  void stopWriter();
+
+  // Register a scan of file. It is to start at the page the scans of
+  // the file in progress have got to, which is returned, or at
+  // firstPage if there are none. reportScan() notes the page a scan
+  // has got to, leaveScan() ends it.
+  const int joinScan(const File* file, const int firstPage);
+  void reportScan(const File* file, const int pageNo);
+  void leaveScan(const File* file);
+
   const BufStats & getBufStats() const // get buffer pool usage
   {
 	return bufStats;
@@ -136,6 +219,16 @@ public:
   {
 	bufStats.clear();
   }
+
+  const int numBuffers() const // # of frames in the buffer pool
+  {
+	return numBufs;
+  }
+
+  const bool directIO() const // open files with O_DIRECT?
+  {
+	return bufStats.ioMode == DIRECTIO;
+  }
 };
 
 #endif
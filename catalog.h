@@ -28,7 +28,7 @@ typedef struct {
 typedef struct {
   char relName[MAXNAME];                // relation name
   char attrName[MAXNAME];               // attribute name
-  int  attrType;                        // INT    EGER, FLOAT, or STRING
+  int  attrType;                        // INTEGER, FLOAT, STRING or VARCHAR
   int  attrLen;                         // length of attribute in bytes
   void *attrValue;                      // ptr to binary value
 } attrInfo; 
@@ -48,10 +48,11 @@ class RelCatalog : public HeapFile {
   // remove tuple from catalog
   const Status removeInfo(const string & relation);
 
-  // create a new relation
+  // create a new relation, stored in slotted, PAX or compressed pages
   const Status createRel(const string & relation, 
 		   const int attrCnt, 
-		   const attrInfo attrList[]);
+		   const attrInfo attrList[],
+		   const PageLayout layout = ROWLAYOUT);
 
   // destroy a relation
   const Status destroyRel(const string & relation);
@@ -116,6 +117,12 @@ extern RelCatalog  *relCat;
 extern AttrCatalog *attrCat;
 extern Error error;
 extern Status createHeapFile(const string filename);
+extern Status createPaxFile(const string filename, const int attrCnt,
+			    const int attrLen[]);
+extern Status createCompressedFile(const string filename);
+extern Status createVarcharFile(const string filename,
+				const PageLayout layout, const int attrCnt,
+				const int attrLen[], const char attrVar[]);
 extern Status destroyHeapFile(const string filename);
 
 #endif
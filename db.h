@@ -5,6 +5,8 @@
 #include <functional>
 #include "error.h"
 #include <string.h>
+#include <set>
+#include <vector>
 using namespace std;
 
 // define if debug output wanted
@@ -18,6 +20,8 @@ class DB;
 // class definition for open files
 class File {
   friend class DB;
+  friend class BufMgr;
+  friend class LogMgr;
   friend class OpenFileHashTbl;
 
  public:
@@ -29,6 +33,7 @@ class File {
   const Status writePage(const int pageNo,
 		   const Page* pagePtr);      // write page to file
   const Status getFirstPage(int& pageNo) const;     // returns pageNo of first page
+  void adviseScan(const int pageNo) const;  // hint a scan is at pageNo
 
   bool operator == (const File & other) const
     {
@@ -51,6 +56,16 @@ class File {
   const Status intwrite(const int pageNo,
 		  const Page* pagePtr);       // internal file write
 
+  Page* directBuf(const Page* pagePtr) const; // aligned buffer for O_DIRECT
+  bool refuseDirect() const;          // fall back from O_DIRECT
+
+  const Status mapPage(const int pageNo,
+		 Page*& pagePtr);     // pin page in file mapping
+  const Status unmapPage(const int pageNo);   // unpin it
+
+  const Status extendTo(const int pageNo);    // file has pages to pageNo
+  const Status sync();                // make the writes durable
+
 #ifdef DEBUGFREE
   void listFree();                      // list free pages
 #endif
@@ -58,6 +73,11 @@ class File {
   string fileName;                    // The name of the file
   int openCnt;                        // # times file has been opened
   int unixFile;                       // unix file stream for file
+  mutable bool direct;                // opened with O_DIRECT
+  char* mapAddr;                      // read-only mapping of file, or NULL
+  size_t mapLen;                      // # bytes mapped
+  int mapPins;                        // # pins of pages in the mapping
+  bool unsynced;                      // written since the last sync()
 };
 
 class BufMgr;
@@ -94,6 +114,9 @@ public:
 
     // returns OK if fileName was found.  Else return HASHTBLERROR
     Status erase(const string fileName);
+
+    // appends the file objects of all open files to files
+    void getFiles(vector<File*> & files);
 };
 
 
@@ -109,8 +132,12 @@ class DB {
   const Status openFile(const string & fileName, File* & file);  // open a file
   const Status closeFile(File* file);         // close a file
 
+  // make the writes to the files of the database durable
+  const Status syncFiles();
+
  private:
   OpenFileHashTbl   openFiles;    // list of open files
+  set<string>       unsynced;     // files closed since written, not synced
 };
 
 
@@ -0,0 +1,48 @@
+#ifndef DISTINCT_H
+#define DISTINCT_H
+
+#include "catalog.h"
+#include "query.h"
+#include "workmem.h"
+
+// define if debug output wanted
+//#define DEBUGDISTINCT
+
+
+// In-memory set of fixed-length keys for duplicate elimination.
+// Keys are stored back to back in one array that is sized from the
+// memory grant up front; an open-addressing index (linear probing,
+// at most half full) maps hash values to keys. The table never
+// grows: once it is full, insert() reports INSUFMEM for keys it has
+// not seen and the caller must deal with them some other way.
+
+class HashDistinct {
+ public:
+  HashDistinct(const int keyLen,        // length of a key
+	       MemGrant & grant,        // memory for the table
+	       Status & status);
+  ~HashDistinct();
+
+  static int keyBytes(const int keyLen); // memory cost of a key
+
+  // add key to the set; isNew tells whether it was not there before.
+  // Returns INSUFMEM (with isNew true) if key is new but the table
+  // is full.
+  Status insert(const char* key, bool & isNew);
+
+  int count() const { return numKeys; } // # of distinct keys in table
+
+ private:
+  const unsigned int hash(const char* key) const;
+
+  MemGrant & grant;
+  int keyLen;
+  int maxKeys;                          // capacity within memory budget
+  int numKeys;                          // # of keys in table
+  char* keys;                           // key storage
+  unsigned int* hashes;                 // hash value of each key
+  int idxSize;                          // # of index slots (power of 2)
+  int* index;                           // key numbers, -1 if slot empty
+};
+
+#endif
@@ -40,6 +40,10 @@ enum Status {
 // SortedFile errors
  
        BADSORTPARM, INSUFMEM, 
+
+// Temporary file errors
+
+       SPILLQUOTA,
 	
 // Catalog errors
 
@@ -0,0 +1,85 @@
+#ifndef EXPLAIN_H
+#define EXPLAIN_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "page.h"
+#include "buf.h"
+
+
+// Statistics of one operator invocation. Times, buffer counts and
+// temporary pages include those of operators nested in it.
+
+typedef struct {
+  string op;                            // operator and its input
+  int depth;                            // nesting level, 0 at top
+  double wallTime;                      // elapsed seconds
+  double cpuTime;                       // user + system seconds
+  int tuplesIn;                         // tuples read from inputs
+  int tuplesOut;                        // tuples produced
+  int hits;                             // buffer pool hits
+  int misses;                           // buffer pool misses
+  int diskReads;                        // pages read from disk
+  int diskWrites;                       // pages written to disk
+  int tempPages;                        // pages of temporary files
+} OPSTAT;
+
+
+// The operator statistics manager collects an OPSTAT for every
+// operator that runs between start() and stop(), for EXPLAIN
+// ANALYZE. Operators are entered with open() and left with close()
+// (usually through an OpProfile); buffer counts are attributed by
+// taking differences of the buffer manager statistics.
+
+class OpStatsMgr {
+ public:
+  OpStatsMgr();
+
+  void start();                         // begin collecting
+  void stop();                          // stop collecting
+  bool isActive() const { return active; }
+
+  int open(const string & op);          // returns handle of operator
+  void close(const int op);
+  void addTuples(const int op, const int in, const int out);
+  void addTempPages(const int pages);   // charged to all open operators
+
+  void printSelf();
+
+ private:
+  typedef struct {
+    int stat;                           // index into stats
+    double wallTime;                    // clocks at open()
+    double cpuTime;
+    BufStats bufStats;
+  } OPENOP;
+
+  bool active;
+  vector<OPSTAT> stats;                 // in order of open()
+  vector<OPENOP> openOps;               // stack of open operators
+  OPSTAT total;                         // whole statement
+  OPENOP totalStart;
+};
+
+extern OpStatsMgr* opStats;
+
+
+// An OpProfile records the statistics of one operator invocation
+// from its construction to its destruction, if statistics are being
+// collected; otherwise it costs next to nothing.
+
+class OpProfile {
+ public:
+  OpProfile(const string & op);
+  ~OpProfile();
+
+  void in(const int n = 1)  { if (stat >= 0) opStats->addTuples(stat, n, 0); }
+  void out(const int n = 1) { if (stat >= 0) opStats->addTuples(stat, 0, n); }
+
+ private:
+  int stat;                             // handle, -1 if not collecting
+};
+
+#endif
@@ -20,10 +20,17 @@ extern DB db;
 
 // Some constant definitions
 const unsigned MAXNAMESIZE = 50;
+const int MAXHDRATTRS = 64;             // max. # of attributes in a file header
 
-enum Datatype { STRING, INTEGER, FLOAT };    // attribute data types
+enum Datatype { STRING, INTEGER, FLOAT, VARCHAR }; // attribute data types
 enum Operator { LT, LTE, EQ, GTE, GT, NE };  // scan operators
 
+// where the value of a varchar attribute is in a stored record
+typedef struct {
+  short offset;                 // offset of the string in the record
+  short length;                 // length of the string
+} VARFIELD;
+
 struct FileHdrPage
 {
   char		fileName[MAXNAMESIZE];   // name of file
@@ -31,6 +38,14 @@ struct FileHdrPage
   int		lastPage;	// pageNo of last data page in file
   int		pageCnt;	// number of pages
   int		recCnt;		// record count
+  int		layout;		// ROWLAYOUT, PAXLAYOUT or COMPRESSEDLAYOUT
+  double	rawBytes;	// bytes of the records stored
+  double	storedBytes;	// same after compression
+  int		attrCnt;	// PAX, varchar, compressed: number of attributes
+  int		attrLen[MAXHDRATTRS]; // same: attribute lengths
+  int		varCnt;		// number of varchar attributes
+  char		attrVar[MAXHDRATTRS]; // attribute is a varchar
+  LSN		lsn;		// LSN of the last logged change (see LogMgr)
 };
 
 
@@ -45,7 +60,35 @@ protected:
    Page* 	curPage;	// data page currently pinned in buffer pool
    int   	curPageNo;	// page number of pinned page
    bool  	curDirtyFlag;   // true if page has been updated
+   bool  	curMapped;      // true if page is pinned in a file mapping
    RID   	curRec;         // rid of last record returned
+   char		recBuf[PAGESIZE]; // record assembled or decompressed
+   string	logName;	// file name in the log, empty if not logged
+   LSN		lastLSN;	// LSN of the last change logged
+
+   // pin page curPageNo as curPage for reading; in MAPPEDIO mode the
+   // page may be read in place from a mapping of the file
+   const Status readCurPage();
+   const Status unpinCurPage();
+
+   // have curPage in the buffer pool, so that it may be modified
+   const Status writeCurPage();
+
+   // initialize a newly allocated data page in the file's layout
+   void initPage(Page* page, const int pageNo) const;
+
+   // record rid of the pinned page, as stored by the user
+   const Status readRecord(const RID & rid, Record & rec);
+
+   // convert a record with varchar attributes to the stored form and
+   // back; both return the length of the converted record
+   int packRecord(const char* src, char* dst) const;
+   int unpackRecord(const char* src, char* dst) const;
+
+   // the same for the records of a compressed file with attributes,
+   // which are encoded attribute by attribute
+   int encodeRecord(const char* src, char* dst) const;
+   int decodeRecord(const char* src, char* dst) const;
 
 public:
 
@@ -58,6 +101,20 @@ public:
   // return number of records in file
   const int getRecCnt() const;
 
+  // return number of pages in file
+  const int getPageCnt() const;
+
+  // return page layout of file
+  const PageLayout getLayout() const;
+
+  // return bytes of the records in file, before and after compression
+  // and packing of varchar attributes
+  const double getRawBytes() const;
+  const double getStoredBytes() const;
+
+  // return number of varchar attributes of the records in file
+  const int getVarcharCnt() const;
+
   // given a RID, read record from file, returning pointer and length
   const Status getRecord(const RID &rid, Record & rec);
 };
@@ -107,8 +164,27 @@ private:
     // scan to be rolled back to the following
     int   markedPageNo;	// page number of pinned page
     RID   markedRec;         // rid of last record returned
+    bool  markedWrapped;     // wrapped as well
+
+    // A scan of a relation larger than a quarter of the buffer pool
+    // starts at the page the other scans of the relation in progress
+    // have got to and reads the pages they have just read while they
+    // are still in the pool; it then wraps around from the last page
+    // to the first one and stops at the page it started on.
+    bool  synced;            // registered with the buffer manager
+    int   startPageNo;       // page the scan started on
+    bool  wrapped;           // went on from the last page to the first
+
+    // On PAX pages a filter on a whole attribute is applied to its
+    // minipage at once, and the outcome for every slot kept here
+    int   filterAttr;        // attribute # of filter, -1 if none
+    int   matchPageNo;       // page the outcomes are for, -1 if none
+    int   matchCnt;          // # of slots evaluated
+    char  matchSlot[PAGESIZE]; // outcome per slot
 
     const bool matchRec(const Record & rec) const;
+    const Status matchCurrent(bool & match);
+    const Status syncScan();
 };
 
 
@@ -123,6 +199,34 @@ public:
 
     // insert record into file, returning its RID
     const Status insertRecord(const Record & rec, RID& outRid); 
+
+private:
+    void logInsert(const Record & rec, const Record & stored);
 };
 
+// apply a scan predicate (attr op filter) to a single attribute value
+const bool matchFilter(const char* attr,
+		       const int length,
+		       const Datatype type,
+		       const char* filter,
+		       const Operator op);
+
+// Compress a record of length bytes into dst, which must have room
+// for length + length / 128 + 1 bytes; returns the compressed length.
+int compressRecord(const char* src, const int length, char* dst);
+
+// Decompress a compressed record of length bytes into dst; returns
+// the length of the record.
+int decompressRecord(const char* src, const int length, char* dst);
+
+// apply a scan predicate to cnt values stored back to back at values
+// (a PAX minipage), setting match[i] to 1 or 0 for the i-th value
+void matchColumn(const char* values,
+		 const int cnt,
+		 const int length,
+		 const Datatype type,
+		 const char* filter,
+		 const Operator op,
+		 char* match);
+
 #endif
@@ -0,0 +1,42 @@
+#ifndef INSERT_H
+#define INSERT_H
+
+#include "catalog.h"
+#include "query.h"
+#include "explain.h"
+
+
+// Inserts tuples into one relation. The schema is looked up and the
+// relation opened once for the whole batch: the constructor reads
+// the catalog and opens an InsertFileScan, which keeps the last page
+// of the relation pinned while tuples are appended to it. The
+// mapping from the attribute list of insert() to the attributes of
+// the relation is worked out on the first call and reused as long as
+// the attributes come in the same order. QU_Insert is a batch of one.
+
+class InsertBatch {
+ public:
+  InsertBatch(const string & relation, Status & status);
+  ~InsertBatch();
+
+  // insert a tuple with the given attribute values (as in QU_Insert)
+  const Status insert(const int attrCnt, const attrInfo attrList[]);
+
+  int count() const { return inserted; }
+
+ private:
+  // find every attribute of the relation in attrList
+  const Status mapAttrs(const attrInfo attrList[]);
+
+  string relation;
+  OpProfile prof;
+  int attrCnt;                          // # of attributes of relation
+  AttrDesc* attrs;                      // their descriptors
+  int* from;                            // attrList index of each
+  int recLen;                           // length of a tuple
+  char* data;                           // tuple being assembled
+  InsertFileScan* ifs;
+  int inserted;                         // # of tuples inserted
+};
+
+#endif
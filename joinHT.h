@@ -1,40 +1,74 @@
+#ifndef JOINHT_H
+#define JOINHT_H
+
+#include <vector>
+using namespace std;
+
+#include "catalog.h"
+
+
+// Hash table for the build side of a hash join. The build tuples
+// (usually only the columns the join needs, see hashJoinFiles) are
+// copied into the table, so that a probe hands out the matching
+// tuples themselves instead of RIDs to fetch from the relation.
+//
+// Tuples are carved out of large chunks (the arena) and freed all at
+// once. The directory is open addressing with linear probing; every
+// slot holds the hash value of its key (to skip most key
+// comparisons) and the chain of all tuples with that key, so that
+// heavily duplicated keys take a single slot. A probe is a scan:
+// startProbe() looks up the key, probeNext() returns one matching
+// tuple at a time.
 
 class joinHashTbl
 {
-private:
-    union JAttrType
-    {
-	int iValue;
-	float fValue;
-	char* sValue;
-    };
-	
-    struct joinhashBucket
-    {
-	union JAttrType	attrValue;
-       	RID	rid;
-       	joinhashBucket*     next;    // next node in the hash table
-    };
-
-    struct HTentry
-    {
-	int bucketCnt;  // nuumber of buckets on this chain
-	joinhashBucket*   chain;  // pointer to first bucket on the chain
-    };
-
-    AttrDesc 	joinAttr;
-    int 	HTSIZE;
-    HTentry 	*ht; // actual hash table
-    int  hash(const char* attr, int attrType); // returns value between 0 and HTSIZE-1
-
-public:
-    joinHashTbl(const int size, const AttrDesc attr);  // constructor
-    ~joinHashTbl();
-
-     // insert a new (JoinAttrValue, RID) pair into hash table
-     Status insert(const RID newRid,  const char* tuple);
-
-     // get RIDs of records whose join attribute value matches innerJoinAttrValue
-     Status lookup(const char* innerJoinAttrPtr, int & ridCount, RID *&outRids);
+ public:
+  joinHashTbl(const int capacity,       // max. # of tuples inserted
+	      const AttrDesc & attr,    // join attribute within a tuple
+	      const int tupleLen,       // length of a build tuple
+	      Status & status);
+  ~joinHashTbl();
+
+  // memory taken by one tuple of length tupleLen (directory included)
+  static int entryBytes(const int tupleLen);
+
+  // copy tuple into the table
+  Status insert(const char* tuple);
+
+  // look up the tuples whose join attribute equals the value at key
+  void startProbe(const char* key);
+
+  // next matching tuple; HASHNOTFOUND when there are no more
+  Status probeNext(const char* & tuple);
+
+  int count() const { return numEntries; }
+
+  // hash value of the join attribute value at key
+  unsigned int hash(const char* key) const;
+
+ private:
+  typedef struct {
+    unsigned int hash;                  // hash value of the key
+    char* first;                        // chain of tuples, NULL if free
+  } JSLOT;
+
+  bool equal(const char* a, const char* b) const;
+  JSLOT* find(const char* key, const unsigned int h) const;
+
+  AttrDesc attr;                        // join attribute
+  int tupleLen;
+  int entryLen;                         // bytes per tuple in the arena
+  int capacity;
+  int numEntries;
+
+  int dirSize;                          // # of slots (power of 2)
+  JSLOT* dir;                           // the directory
+
+  vector<char*> chunks;                 // the arena
+  int chunkUsed;                        // bytes used in last chunk
+  int chunkLen;                         // size of last chunk in bytes
+
+  char* cursor;                         // next tuple of current probe
 };
 
+#endif
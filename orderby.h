@@ -0,0 +1,103 @@
+#ifndef ORDERBY_H
+#define ORDERBY_H
+
+#include "catalog.h"
+#include "query.h"
+#include "workmem.h"
+#include "explain.h"
+
+// define if debug output wanted
+//#define DEBUGORDER
+
+
+// Bounded-memory top-N operator for ORDER BY ... LIMIT n. Only the
+// n best tuples seen so far are kept, in a binary heap whose root is
+// the kept tuple that sorts last; a new tuple either replaces the
+// root or is dropped. No runs are ever written to disk. emit() sorts
+// the heap in place and writes the tuples out in order.
+
+class TopN {
+ public:
+  TopN(const int n,                     // # of tuples to keep
+       const int recLen,                // length of a tuple
+       const int offset,                // sort attribute
+       const int length,
+       const Datatype type,
+       const bool descending,           // largest value first
+       Status & status);
+  ~TopN();
+
+  Status insert(const Record & rec);    // offer one tuple
+  Status emit(InsertFileScan* result);  // write kept tuples in order
+  int size() const { return count; }    // # of tuples kept
+
+ private:
+  int cmp(const char* r1, const char* r2) const; // sort order of tuples
+  void siftDown(int i, const int size);
+
+  int n;
+  int recLen;
+  int offset;
+  int length;
+  Datatype type;
+  int dir;                              // 1 if ascending, -1 if descending
+
+  char* data;                           // space for n tuples
+  char** heap;                          // heap of tuples, last one on top
+  int count;                            // # of tuples in heap
+};
+
+
+
+// ORDER BY ... LIMIT n of a select or join, evaluated on the tuples
+// the operator writes to its result relation as they are produced,
+// without staging them in a relation first. Between start() and
+// finish() every ResultRel on the result relation hands its tuples
+// to a TopN heap; finish() appends the kept ones to the relation in
+// order. If the workspace grant cannot hold n tuples, start() leaves
+// it inactive and the query must be staged and sorted by QU_OrderBy.
+
+class TopNResult {
+ public:
+  TopNResult();
+  ~TopNResult();                        // drops the tuples if unfinished
+
+  Status start(const string & result,   // relation the operator writes
+	       const int recLen,        // length of its tuples
+	       const AttrDesc & sortAttr, // offset is the one in result
+	       const bool descending,
+	       const int limit);
+  bool active() const { return topN != NULL; }
+  Status put(const Record & rec);       // a tuple written to result
+  Status finish();                      // write kept tuples to result
+
+  static TopNResult* on(const string & relName); // active one, or NULL
+
+ private:
+  void stop();
+
+  string result;
+  TopN* topN;
+  MemGrant* grant;
+  OpProfile* prof;
+
+  static TopNResult* current;           // at most one query at a time
+};
+
+
+// The result relation of a select or join. Tuples are inserted into
+// the relation unless a TopNResult is active on it, which then gets
+// them instead.
+
+class ResultRel {
+ public:
+  ResultRel(const string & relName, Status & status);
+
+  const Status insertRecord(const Record & rec, RID & outRid);
+
+ private:
+  InsertFileScan rel;
+  TopNResult* order;                    // top-N taking the tuples
+};
+
+#endif
@@ -22,17 +22,46 @@ struct slot_t {
         short	length;  // equals -1 if slot is not in use
 };
 
+// page layouts: slotted pages holding whole records, PAX pages
+// holding every attribute in a minipage of its own, or slotted pages
+// holding compressed records (see HeapFile::encodeRecord and
+// compressRecord)
+enum PageLayout { ROWLAYOUT, PAXLAYOUT, COMPRESSEDLAYOUT };
+
+// log sequence number: offset into the write-ahead log counted from
+// the creation of the database (see LogMgr). It only ever grows, so
+// it is 64 bits wide.
+typedef long long LSN;
+
 const unsigned PAGESIZE = 1024;
-const unsigned DPFIXED= sizeof(slot_t)+4*sizeof(short)+2*sizeof(int);
+const unsigned DPFIXED= sizeof(slot_t)+6*sizeof(short)+2*sizeof(int)
+			+sizeof(LSN);
 const unsigned PAGEDATASIZE = PAGESIZE-DPFIXED+sizeof(slot_t);
 // size of the data area of a page
 
 // Class definition for a minirel data page.   
-// The design assumes that records are kept compacted when
-// deletions are performed. Notice, however, that the slot
+// Deleting a record only frees its slot; the bytes of the record
+// are left as a hole in data[] until compact() is called, or until
+// an insert finds freeSpace enough for the record but the space
+// after freePtr too small. So a scan that deletes many records of a
+// page moves the remaining ones once, not once per deleted record.
+// freeSpace counts the holes. Notice, however, that the slot
 // array cannot be compacted.  Notice, this class does not keep
 // the records align, relying instead on upper levels to take
 // care of non-aligned attributes
+//
+// A PAX page holds fixed-length records of one relation and stores
+// each attribute in a minipage of its own: the values of an attribute
+// for all records on the page lie back to back, so that a scan
+// predicate on one attribute reads only that attribute's minipage.
+// data[] starts with a directory (attribute count, number of record
+// slots, offset and length of every minipage) and one presence byte
+// per slot; the minipages follow, each aligned to PAXALIGN. Deleting
+// a record only clears its presence byte, nothing is moved. slotCnt
+// counts slots as on a slotted page, up to the last one in use.
+// Records of a PAX page are assembled in a buffer of the caller's.
+
+const int PAXALIGN = sizeof(int);      // alignment of minipages
 
 class Page {
 private:
@@ -41,24 +70,40 @@ private:
     short	slotCnt; // number of slots in use;
     short	freePtr; // offset of first free byte in data[]
     short	freeSpace; // number of bytes free in data[]
-    short	dummy;	// for alignment purposes
+    short	layout;	// ROWLAYOUT or PAXLAYOUT (a COMPRESSEDLAYOUT
+			// file has ROWLAYOUT pages)
+    short	holes;	// bytes of deleted records not yet reclaimed
+    short	freeSlot; // no slot below this one is free
     int		nextPage; // forwards pointer
     int		curPage;  // page number of current pointer
+    LSN		lsn;      // LSN of the last logged change (see LogMgr)
 
 public:
     void init(const int pageNo); // initialize a new page
+
+    // initialize a new PAX page for records with the given attributes
+    void initPax(const int pageNo, const int attrCnt, const int attrLen[]);
+
+    // number of records that fit on a PAX page, 0 if not even one
+    static int paxSlots(const int attrCnt, const int attrLen[]);
     void dumpPage() const;       // dump contents of a page
 
     const Status getNextPage(int& pageNo) const; // returns value of nextPage
     const Status setNextPage(const int pageNo); // sets value of nextPage to pageNo
     const short getFreeSpace() const; // returns amount of free space
 
+    const LSN getLSN() const { return lsn; }
+    void setLSN(const LSN newLSN) { lsn = newLSN; }
+
     // inserts a new record (rec) into the page, returns RID of record 
     const Status insertRecord(const Record & rec, RID& rid);
 
     // delete the record with the specified rid
     const Status deleteRecord(const RID & rid);
 
+    // move the records together, reclaiming the holes left by deletes
+    void compact();
+
     // returns RID of first record on page
     // returns  NORECORDS if page contains no records.  Otherwise, returns OK
     const Status firstRecord(RID& firstRid) const;
@@ -67,8 +112,30 @@ public:
     // returns ENDOFPAGE if no more records exist on the page
     const Status nextRecord (const RID & curRid, RID& nextRid) const;
 
-    // returns reference to record with RID rid
+    // returns reference to record with RID rid (slotted pages only)
     const Status getRecord(const RID & rid, Record & rec);
+
+    // same for either layout; a PAX record is assembled in buf
+    const Status getRecord(const RID & rid, Record & rec, char* buf);
+
+    const bool isPax() const { return layout == PAXLAYOUT; }
+
+    // PAX only: the minipage of attribute attr (values are indexed by
+    // slot number), and the number of slots up to the last one in use
+    const char* getColumn(const int attr) const;
+    const int getSlotCnt() const { return -slotCnt; }
+
+private:
+    // PAX directory
+    short* paxDir() { return (short*) data; }
+    const short* paxDir() const { return (const short*) data; }
+    char* paxUsed() { return data + sizeof(short) * (2 + 2 * paxDir()[0]); }
+    const char* paxUsed() const
+      { return data + sizeof(short) * (2 + 2 * paxDir()[0]); }
+
+    const Status paxInsert(const Record & rec, RID& rid);
+    const Status paxDelete(const RID & rid);
+    const Status paxNext(int slotNo, RID& nextRid) const;
 };
 
 #endif
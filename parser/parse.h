@@ -65,7 +65,10 @@ typedef enum {
     N_ATTRTYPE,
     N_VALUE,
     N_LIST,
-    N_ALIAS
+    N_ALIAS,
+    N_AGGR,
+    N_ORDERBY,
+    N_EXPLAIN
 } NODEKIND;
 
 
@@ -82,12 +85,17 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *qual;
+	    struct node *groupby;
+	    struct node *orderby;
+	    int limit;			// -1 if no limit
+	    int distinct;		// 1 if duplicates are removed
 	} QUERY;
 
 	// insert node */
 	struct {
 	    char *relname;
 	    struct node *attrlist;
+	    struct node *rows;		// list of value lists, one per tuple
 	} INSERT;
 
 	// delete node */
@@ -101,6 +109,7 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *primattr;
+	    int layout;			// ROWLAYOUT, PAXLAYOUT, ...
 	} CREATE;
 
 	// destroy node */
@@ -149,6 +158,8 @@ typedef struct node {
 	    struct node *joinattr1;
 	    int op;
 	    struct node *joinattr2;
+	    struct node *below;		// band join offsets, NULL for op
+	    struct node *above;
 	} JOIN;
 
 	// qualified attribute node */
@@ -176,6 +187,7 @@ typedef struct node {
 	    // type of the attribute
 	    // 'i'-128 means integer
 	    // 'f'-128 means real
+	    // 256 + length means varchar of that length
 	    // otherwise means length of string
 
 	   // char *type;
@@ -203,6 +215,24 @@ typedef struct node {
 	  char *relname;
 	  char *alias;
 	} ALIAS;
+
+	// aggregate function applied to a qualified attribute */
+	struct {
+	  char *func;
+	  struct node *qualattr;	// attrname is NULL for COUNT(*)
+	  int distinct;			// 1 if over distinct values only
+	} AGGR;
+
+	// order by clause */
+	struct {
+	  struct node *qualattr;
+	  int desc;			// 1 if descending
+	} ORDERBY;
+
+	// explain analyze node */
+	struct {
+	  struct node *cmd;		// query, insert or delete
+	} EXPLAIN;
     } u;
 } NODE;
 
@@ -212,10 +242,11 @@ typedef struct node {
 //
 
 NODE *newnode(int kind);
-NODE *query_node(char *relname, NODE *attrlist, NODE *n);
-NODE *insert_node(char *relname, NODE *attrlist);
+NODE *query_node(char *relname, NODE *attrlist, NODE *n, NODE *groupby,
+		 NODE *orderby, int limit, int distinct);
+NODE *insert_node(char *relname, NODE *attrlist, NODE *rows);
 NODE *delete_node(char *relname, NODE *qual);
-NODE *create_node(char *relname, NODE *attrlist, NODE *primattr);
+NODE *create_node(char *relname, NODE *attrlist, NODE *primattr, int layout);
 NODE *destroy_node(char *relname);
 NODE *build_node(char *relname, char *attrname, int nbuckets);
 NODE *rebuild_node(char *relname, char *attrname, int nbuckets);
@@ -225,6 +256,9 @@ NODE *print_node(char *relname);
 NODE *help_node(char *relname);
 NODE *select_node(NODE *selattr, int op, NODE *value);
 NODE *join_node(NODE *joinattr1, int op, NODE *joinattr2);
+NODE *band_node(NODE *joinattr1, NODE *joinattr2, NODE *below, NODE *above);
+NODE *neg_value(NODE *value);
+int same_qualattr(NODE *qualattr1, NODE *qualattr2);
 NODE *qualattr_node(char *relname, char *attrname);
 NODE *primattr_node(char *attrname, int nbuckets);
 NODE *attrval_node(char *attrname, NODE *value);
@@ -235,8 +269,11 @@ NODE *float_node(float rval);
 NODE *string_node(char *s);
 NODE *list_node(NODE *n);
 NODE *prepend(NODE *n, NODE *list);
-NODE *merge_attr_value_list(NODE *attr_list, NODE *value_list);
+NODE *match_attr_rows(NODE *attr_list, NODE *row_list);
 NODE *alias_node(char *relname, char *alias);
+NODE *aggr_node(char *func, NODE *qualattr, int distinct);
+NODE *orderby_node(NODE *qualattr, int desc);
+NODE *explain_node(NODE *cmd);
 NODE *replace_alias_in_qualattr_list(NODE *alias, NODE *qualattr_list);
 NODE *replace_alias_in_condition(NODE *alias, NODE *where);
 #endif
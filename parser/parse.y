@@ -7,6 +7,9 @@
 #include <stdio.h>
 #include "heapfile.h"
 #include "parse.h"
+#include "tempfile.h"
+#include "workmem.h"
+#include "wal.h"
 
 extern "C" int isatty(int);
 extern int yylex();
@@ -51,9 +54,22 @@ static NODE *parse_tree;                // root of parse tree
 		RW_OR
 		RW_NOT
 		RW_VALUES	
+		RW_GROUP
+		RW_BY
+		RW_ORDER
+		RW_ASC
+		RW_DESC
+		RW_LIMIT
+		RW_DISTINCT
+		RW_EXPLAIN
+		RW_ANALYZE
+		RW_BETWEEN
+		RW_PAX
+		RW_COMPRESSED
 		INT_TYPE
 		REAL_TYPE
 		CHAR_TYPE	
+		VARCHAR_TYPE
 		T_EQ
 		T_LT
 		T_LE
@@ -73,12 +89,17 @@ static NODE *parse_tree;                // root of parse tree
 		T_SHELL_CMD
 
 %type	<ival>	op
+		opt_direction
+		opt_limit
+		opt_distinct
+		opt_layout
 
 %type	<sval>	opt_into_relname
 		opt_relname
 		string
 
 %type	<n>	command
+		explain
 		query
 		insert
 		delete
@@ -99,6 +120,11 @@ static NODE *parse_tree;                // root of parse tree
 		selection
 		join
 		non_mt_qualattr_list
+		non_mt_selattr_list
+		selattr
+		aggr
+		opt_groupby
+		opt_orderby
 		qualattr
 /*
 		non_mt_attrval_list
@@ -107,8 +133,10 @@ static NODE *parse_tree;                // root of parse tree
 		non_mt_attrtype_list
 		attrtype
 		value
+		offset
 		attrib
 		attrib_list
+		row_list
 		value_list
 		val
 		table_list
@@ -142,7 +170,8 @@ start
 	;
 
 command
-	: query
+	: explain
+	| query
 	| insert
 	| delete
 	| create
@@ -162,22 +191,47 @@ command
 	}
 	;
 
+explain
+	: RW_EXPLAIN RW_ANALYZE query
+	{
+		$$ = ($3 == NULL) ? NULL : explain_node($3);
+	}
+	| RW_EXPLAIN RW_ANALYZE insert
+	{
+		$$ = ($3 == NULL) ? NULL : explain_node($3);
+	}
+	| RW_EXPLAIN RW_ANALYZE delete
+	{
+		$$ = ($3 == NULL) ? NULL : explain_node($3);
+	}
+	;
+
 query
-	: RW_SELECT non_mt_qualattr_list opt_into_relname RW_FROM table_list opt_where
+	: RW_SELECT opt_distinct non_mt_selattr_list opt_into_relname RW_FROM table_list opt_where opt_groupby opt_orderby opt_limit
 /*	RW_SELECT opt_into_relname '(' non_mt_qualattr_list ')' opt_where */
 	{
 		NODE *where;
-		NODE *qualattr_list = replace_alias_in_qualattr_list($5, $2);
+		NODE *groupby = NULL;
+		NODE *qualattr_list = replace_alias_in_qualattr_list($6, $3);
 		if (qualattr_list == NULL) { // something wrong in qualattr_list
 		  $$ = NULL;
 		}
+		else if ($8 != NULL &&
+		         (groupby = replace_alias_in_qualattr_list($6, $8)) == NULL) {
+		  $$ = NULL; // something wrong in group by list
+		}
+		else if ($9 != NULL &&
+		         replace_alias_in_qualattr_list($6,
+			     list_node($9->u.ORDERBY.qualattr)) == NULL) {
+		  $$ = NULL; // something wrong in order by attribute
+		}
 		else {
-		  where = replace_alias_in_condition($5, $6);
-		  if ((where == NULL) && ($6 != NULL)) {
+		  where = replace_alias_in_condition($6, $7);
+		  if ((where == NULL) && ($7 != NULL)) {
 		     $$ = NULL; //something wrong in where condition
 		  }
 		  else {
-		    $$ = query_node($3, qualattr_list, where);
+		    $$ = query_node($4, qualattr_list, where, groupby, $9, $10, $2);
 		  }
 		}
 	}
@@ -208,11 +262,24 @@ table
 	}
 
 insert
-	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES '(' value_list ')' 
+	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES row_list
 	{
-		NODE* tmp = merge_attr_value_list($5, $9);
+		NODE* tmp = match_attr_rows($5, $8);
 		if (tmp == NULL) $$=NULL;
-		else $$ = insert_node($3, tmp);
+		else $$ = insert_node($3, $5, tmp);
+	}
+	;
+
+/* left recursive, so that the parser stack does not grow with the
+   number of tuples; the rows come out in reverse order */
+row_list
+	: row_list ',' '(' value_list ')'
+	{
+		$$ = prepend($4, $1);
+	}
+	| '(' value_list ')'
+	{
+		$$ = list_node($2);
 	}
 	;
 
@@ -256,9 +323,9 @@ delete
 	;
 
 create
-	: RW_CREATE RW_TABLE string '(' non_mt_attrtype_list ')' opt_primary_attr
+	: RW_CREATE RW_TABLE string '(' non_mt_attrtype_list ')' opt_primary_attr opt_layout
 	{
-		$$ = create_node($3, $5, $7);
+		$$ = create_node($3, $5, $7, $8);
 	}
 	;
 
@@ -334,6 +401,21 @@ opt_primary_attr
 	}
 	;
 
+opt_layout
+	: RW_PAX
+	{
+		$$ = PAXLAYOUT;
+	}
+	| RW_COMPRESSED
+	{
+		$$ = COMPRESSEDLAYOUT;
+	}
+	| nothing
+	{
+		$$ = ROWLAYOUT;
+	}
+	;
+
 opt_into_relname
 	: RW_INTO string
 	{
@@ -384,6 +466,30 @@ join
 	{
 		$$ = join_node($1, $2, $3);
 	}
+	| qualattr RW_BETWEEN qualattr offset RW_AND qualattr offset
+	{
+		if (!same_qualattr($3, $6)) {
+		  yyerror("both bounds of between must use the same attribute");
+		  YYERROR;
+		}
+		$$ = band_node($1, $3, neg_value($4), $7);
+	}
+	;
+
+offset
+	: '+' value
+	{
+		$$ = $2;
+	}
+	| '-' value
+	{
+		$$ = neg_value($2);
+	}
+	| value
+	| nothing
+	{
+		$$ = int_node(0);
+	}
 	;
 
 non_mt_qualattr_list
@@ -401,6 +507,100 @@ non_mt_qualattr_list
 	}
 	;
 
+non_mt_selattr_list
+	: '(' non_mt_selattr_list ')'
+	{
+		$$ = $2;
+	}
+	| selattr ',' non_mt_selattr_list
+	{
+		$$ = prepend($1, $3);
+	}
+	| selattr
+	{
+		$$ = list_node($1);
+	}
+	;
+
+selattr
+	: qualattr
+	| aggr
+	;
+
+aggr
+	: string '(' qualattr ')'
+	{
+		$$ = aggr_node($1, $3, 0);
+	}
+	| string '(' RW_DISTINCT qualattr ')'
+	{
+		$$ = aggr_node($1, $4, 1);
+	}
+	| string '(' '*' ')'
+	{
+		$$ = aggr_node($1, qualattr_node(NULL, NULL), 0);
+	}
+	;
+
+opt_groupby
+	: RW_GROUP RW_BY non_mt_qualattr_list
+	{
+		$$ = $3;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_orderby
+	: RW_ORDER RW_BY qualattr opt_direction
+	{
+		$$ = orderby_node($3, $4);
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_distinct
+	: RW_DISTINCT
+	{
+		$$ = 1;
+	}
+	| nothing
+	{
+		$$ = 0;
+	}
+	;
+
+opt_direction
+	: RW_ASC
+	{
+		$$ = 0;
+	}
+	| RW_DESC
+	{
+		$$ = 1;
+	}
+	| nothing
+	{
+		$$ = 0;
+	}
+	;
+
+opt_limit
+	: RW_LIMIT T_INT
+	{
+		$$ = $2;
+	}
+	| nothing
+	{
+		$$ = -1;
+	}
+	;
+
 qualattr
 	: string '.' string
 	{
@@ -458,6 +658,10 @@ attrtype
 	{
 		$$ = attrtype_node($1, 2);
 	}
+	| string VARCHAR_TYPE '(' value ')'
+	{
+	 	$$ = attrtype_node($1, 256 + $4->u.VALUE.u.ival);
+	}
 	;
 
 op
@@ -529,9 +733,22 @@ void parse(void)
     printf("%s", PROMPT);
     fflush(stdout);
 
-    // if a query was successfully read, interpret it
-    if(yyparse() == 0 && parse_tree != NULL)
+    // if a query was successfully read, interpret it; the statistics
+    // of grants and temporary files cover one query, temporary files
+    // it leaves behind are destroyed afterwards, and the changes it
+    // made are committed
+    if(yyparse() == 0 && parse_tree != NULL) {
+      workMem->clearStats();
+      tempFiles->clearStats();
       interp(parse_tree);
+      tempFiles->cleanup();
+
+      Status status = logMgr->commit();
+      if (status != OK) {
+        Error error;
+        error.print(status);
+      }
+    }
   }
 }
 
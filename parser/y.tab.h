@@ -78,22 +78,35 @@ extern int yydebug;
     RW_OR = 279,                   /* RW_OR  */
     RW_NOT = 280,                  /* RW_NOT  */
     RW_VALUES = 281,               /* RW_VALUES  */
-    INT_TYPE = 282,                /* INT_TYPE  */
-    REAL_TYPE = 283,               /* REAL_TYPE  */
-    CHAR_TYPE = 284,               /* CHAR_TYPE  */
-    T_EQ = 285,                    /* T_EQ  */
-    T_LT = 286,                    /* T_LT  */
-    T_LE = 287,                    /* T_LE  */
-    T_GT = 288,                    /* T_GT  */
-    T_GE = 289,                    /* T_GE  */
-    T_NE = 290,                    /* T_NE  */
-    T_EOF = 291,                   /* T_EOF  */
-    NOTOKEN = 292,                 /* NOTOKEN  */
-    T_INT = 293,                   /* T_INT  */
-    T_REAL = 294,                  /* T_REAL  */
-    T_STRING = 295,                /* T_STRING  */
-    T_QSTRING = 296,               /* T_QSTRING  */
-    T_SHELL_CMD = 297              /* T_SHELL_CMD  */
+    RW_GROUP = 282,                /* RW_GROUP  */
+    RW_BY = 283,                   /* RW_BY  */
+    RW_ORDER = 284,                /* RW_ORDER  */
+    RW_ASC = 285,                  /* RW_ASC  */
+    RW_DESC = 286,                 /* RW_DESC  */
+    RW_LIMIT = 287,                /* RW_LIMIT  */
+    RW_DISTINCT = 288,             /* RW_DISTINCT  */
+    RW_EXPLAIN = 289,              /* RW_EXPLAIN  */
+    RW_ANALYZE = 290,              /* RW_ANALYZE  */
+    RW_BETWEEN = 291,              /* RW_BETWEEN  */
+    RW_PAX = 292,                  /* RW_PAX  */
+    RW_COMPRESSED = 293,           /* RW_COMPRESSED  */
+    INT_TYPE = 294,                /* INT_TYPE  */
+    REAL_TYPE = 295,               /* REAL_TYPE  */
+    CHAR_TYPE = 296,               /* CHAR_TYPE  */
+    VARCHAR_TYPE = 297,            /* VARCHAR_TYPE  */
+    T_EQ = 298,                    /* T_EQ  */
+    T_LT = 299,                    /* T_LT  */
+    T_LE = 300,                    /* T_LE  */
+    T_GT = 301,                    /* T_GT  */
+    T_GE = 302,                    /* T_GE  */
+    T_NE = 303,                    /* T_NE  */
+    T_EOF = 304,                   /* T_EOF  */
+    NOTOKEN = 305,                 /* NOTOKEN  */
+    T_INT = 306,                   /* T_INT  */
+    T_REAL = 307,                  /* T_REAL  */
+    T_STRING = 308,                /* T_STRING  */
+    T_QSTRING = 309,               /* T_QSTRING  */
+    T_SHELL_CMD = 310              /* T_SHELL_CMD  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -126,35 +139,48 @@ extern int yydebug;
 #define RW_OR 279
 #define RW_NOT 280
 #define RW_VALUES 281
-#define INT_TYPE 282
-#define REAL_TYPE 283
-#define CHAR_TYPE 284
-#define T_EQ 285
-#define T_LT 286
-#define T_LE 287
-#define T_GT 288
-#define T_GE 289
-#define T_NE 290
-#define T_EOF 291
-#define NOTOKEN 292
-#define T_INT 293
-#define T_REAL 294
-#define T_STRING 295
-#define T_QSTRING 296
-#define T_SHELL_CMD 297
+#define RW_GROUP 282
+#define RW_BY 283
+#define RW_ORDER 284
+#define RW_ASC 285
+#define RW_DESC 286
+#define RW_LIMIT 287
+#define RW_DISTINCT 288
+#define RW_EXPLAIN 289
+#define RW_ANALYZE 290
+#define RW_BETWEEN 291
+#define RW_PAX 292
+#define RW_COMPRESSED 293
+#define INT_TYPE 294
+#define REAL_TYPE 295
+#define CHAR_TYPE 296
+#define VARCHAR_TYPE 297
+#define T_EQ 298
+#define T_LT 299
+#define T_LE 300
+#define T_GT 301
+#define T_GE 302
+#define T_NE 303
+#define T_EOF 304
+#define NOTOKEN 305
+#define T_INT 306
+#define T_REAL 307
+#define T_STRING 308
+#define T_QSTRING 309
+#define T_SHELL_CMD 310
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 23 "parse.y"
+#line 24 "parse.y"
 
   int ival;
   float rval;
   char *sval;
   NODE *n;
 
-#line 158 "y.tab.h"
+#line 184 "y.tab.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -2,28 +2,126 @@
 #define PARTITION_H
 
 #include "heapfile.h"
+#include "catalog.h"
+#include "workmem.h"
+#include "explain.h"
+#include "bloom.h"
 
 
 // define if debug output wanted
 //#define DEBUGPART
 
 
+const int PARTMAXLEVEL = 4;             // max. depth of repartitioning
+const int PARTMAXFANOUT = 32;           // max. # of partitions per split
+const int HOTCANDIDATES = 4;            // heavy hitter candidates/partition
+const unsigned int BLOOMSEED = 0x7f4a7c15u; // hash seed of Bloom filter keys
+
+
+// One partition made by Partition.
+
+typedef struct {
+  string name;                          // name of partition heap file
+  int recCnt;                           // # of tuples
+  int pages;                            // # of pages
+  bool hot;                             // all tuples have the same key
+} PARTINFO;
+
+
+// Takes the tuples of the resident partition of a Partition, which
+// are kept in memory instead of being written (hybrid hash join).
+// put() sets taken to false if the tuple must be written to the
+// partition file after all (the memory is full).
+
+class ResidentSink {
+ public:
+  virtual ~ResidentSink() {}
+  virtual Status put(const Record & rec, bool & taken) = 0;
+};
+
+
 class Partition {
  public:
-  Partition(HeapFileScan *rel,              // name of heap file to partition
-	    const string & fileName,             // (base) name of heap file
-	    const int P,                      // number of partitions
-	    const int (*hashfcn)(const Record & rec,
-				 const int P),  
-	                               // hash function to use in partitioning
-	    string* &partName,           // names of partitioned heap files
-	    Status &status);            // create partitions of file
+  Partition(const string & relName,     // heap file to partition
+	    const AttrDesc & attr,      // partitioning attribute
+	    const int maxRecCnt,        // max. # of tuples per partition
+	    BloomFilter* buildFilter,   // gets all keys, if not NULL
+	    ResidentSink* resident,     // takes partition 0, if not NULL
+	    const int residentRecCnt,   // # of tuples it can take
+	    Status & status);           // create partitions of file
+  Partition(const string & relName,     // heap file to partition
+	    const AttrDesc & attr,      // partitioning attribute
+	    const Partition & like,     // the way like was partitioned
+	    const BloomFilter* probeFilter, // drops keys not in it
+	    ResidentSink* resident,     // takes partition 0, if not NULL
+	    Status & status);
   ~Partition();                         // destroy partitions
 
+  int numParts() const { return parts.size(); }
+  const PARTINFO & part(const int p) const { return parts[p]; }
+  int numDropped() const { return dropped; } // by the probe filter
+
  private:
+  // Partitioning is a tree: the relation is split into partitions,
+  // oversized partitions are split again. The leaves are the
+  // partitions; hot leaves hold the tuples of one heavy key.
+
+  typedef struct {
+    unsigned int seed;                  // hash seed of the split
+    int fanout;                         // # of children, 0 for a leaf
+    int child;                          // node # of first child
+    unsigned int share;                 // hash values below go to
+    int resident;                       // this resident leaf
+    int level;                          // depth in the tree
+    string name;                        // heap file of a leaf
+    int recCnt;                         // # of tuples in it
+    int pages;
+    double storedBytes;                 // bytes of its tuples on disk
+    bool hot;
+  } PNODE;
+
+  typedef struct {
+    string key;                         // normalized key of a heavy hitter
+    int node;                           // hot leaf holding its tuples
+  } HOTKEY;
+
+  // A leaf being written: its output buffer and the candidates for
+  // heavy hitters (Misra-Gries counters).
+
+  typedef struct {
+    char* buf;                          // tuples not written yet
+    int used;                           // bytes in buf
+    string cand[HOTCANDIDATES];
+    int candCnt[HOTCANDIDATES];
+  } PARTOUT;
+
+  void init(const string & relName, Status & status);
+  int newLeaf(const int level, const bool hot, Status & status);
+  Status split(const int node, const string & input, const int recCnt,
+	       const vector<string> & hot, MemGrant & grant,
+	       OpProfile & prof);
+  Status distribute(const string & input, const int from, const int first,
+		    vector<PARTOUT> & outs, MemGrant & grant,
+		    OpProfile & prof);
+  Status flush(const int node, PARTOUT & out);
+  void makeParts();
+
+  string keyOf(const char* tuple) const;
+  static unsigned int hash(const string & key, const unsigned int seed);
+  int route(const string & key, const int from) const;
 
-  int P;                                // number of partitions
-  string *partName;                      // partition names
+  string relName;                       // relation partitioned
+  AttrDesc attr;                        // partitioning attribute
+  int recLen;                           // length of its tuples
+  int maxRecCnt;                        // partition size wanted
+  vector<PNODE> nodes;                  // the tree, root is nodes[0]
+  vector<HOTKEY> hotKeys;
+  vector<PARTINFO> parts;               // the leaves, in node order
+  BloomFilter* buildFilter;
+  const BloomFilter* probeFilter;
+  ResidentSink* resident;
+  int residentRecCnt;
+  int dropped;                          // tuples probeFilter ruled out
 };
 
 #endif
@@ -4,6 +4,20 @@
 #include "heapfile.h"
 
 enum JoinType {NLJoin, SMJoin, HashJoin};
+enum AggType {HashAgg, SortAgg};
+
+// aggregate functions allowed in the select list of a query
+
+enum AggFunc {AGG_NONE, AGG_COUNT, AGG_SUM, AGG_AVG, AGG_MIN, AGG_MAX};
+
+// One entry of the select list of an aggregate query: either a
+// grouping attribute (func == AGG_NONE) or an aggregate over attr.
+// For COUNT(*) attr.attrName is the empty string.
+
+typedef struct {
+  attrInfo attr;
+  AggFunc func;
+} aggInfo;
 
 //
 // Prototypes for query layer functions
@@ -24,6 +38,38 @@ const Status QU_Join(const string & result,
 		     const Operator op, 
 		     const attrInfo *attr2);
 
+const Status QU_Band_Join(const string & result,
+			  const int projCnt,
+			  const attrInfo projNames[],
+			  const attrInfo *attr1,
+			  const attrInfo *attr2,
+			  const char *below,   // attr1 >= attr2 - below
+			  const char *above);  // attr1 <= attr2 + above
+
+const Status QU_Aggregate(const string & result,
+			  const int projCnt,
+			  const aggInfo projNames[],
+			  const int groupCnt,
+			  const attrInfo groupNames[],
+			  const attrInfo *attr,
+			  const Operator op,
+			  const char *attrValue);
+
+const Status QU_OrderBy(const string & input,
+			const string & result,
+			const attrInfo *sortAttr,
+			const bool descending,
+			const int limit);
+
+const Status QU_Distinct(const string & input,
+			 const string & result);
+
+const Status QU_CountDistinct(const string & result,
+			      const attrInfo *attr,
+			      const attrInfo *selAttr,
+			      const Operator op,
+			      const char *attrValue);
+
 const Status QU_Insert(const string & relation, 
 		       const int attrCnt, 
 		       const attrInfo attrList[]);
@@ -2,21 +2,35 @@
 #define SORT_H
 
 #include "heapfile.h"
+#include "workmem.h"
+#include "explain.h"
 
 // define if debug output wanted
 //#define DEBUGSORT
 
 
-// SORTREC is an in-memory sort record that qsort(3) sorts.
-// The sort attribute as well as the associated RID are
-// stored in the record. The RID is used for fetching the
-// full record when it is needed.
+// Run generation copies the tuples of the source file into slots of
+// the workspace, each tuple after the normalized form of its sort
+// attribute (length bytes that memcmp(3) orders like the attribute
+// values, see normalizeKey() in sort.C). A workspace that holds the
+// whole file is sorted through sort items, held back to back in one
+// buffer: the normalized key of a tuple followed by its slot number.
+// Keys of up to LSDMAXKEY bytes are sorted with an LSD radix sort,
+// longer keys with an in-place MSD radix sort. With SORTTHREADS,
+// large workspaces of long keys are split into key ranges that are
+// sorted by several threads. The LSD sort and the split need a second
+// buffer. Otherwise runs are formed
+// by replacement selection with a heap of HEAPITEMs.
 
-typedef struct {
-  RID rid;                              // record id of current record
-  char* field;                          // pointer to field
-  int length;                           // length of field
-} SORTREC;
+const int LSDMAXKEY = 8;                // longest key for LSD radix sort
+
+// Sort n sort items of itemLen bytes on their first keyLen bytes, with
+// tmp as a second buffer of the same size; parallelSort() splits them
+// among threads (also used by sortbench).
+void sortItems(char* items, char* tmp, const int n,
+	       const int itemLen, const int keyLen);
+void parallelSort(char* items, char* tmp, const int n,
+		  const int itemLen, const int keyLen, const int threads);
 
 
 class SortedFile {
@@ -24,7 +38,9 @@ class SortedFile {
   SortedFile(const string & fileName, 
 	     int offset,// sort source file on the given
 	     int length, Datatype type, // attribute
-	     int maxItems, Status& status);
+	     int maxItems,              // cap on run size (0: none)
+	     Status& status,
+	     bool descending = false);  // largest value first
 
   Status next(Record & rec);            // fetch next record in sort order
   Status setMark();                     // record a position in sort sequence
@@ -33,31 +49,63 @@ class SortedFile {
 
  private:
   Status sortFile();                    // split source file into sub-runs
+  Status loadRuns(OpProfile & prof);    // runs of workspace size
+  Status replacementSelection(OpProfile & prof); // longer runs
   Status generateRun(int numItems);     // generate one sub-run of file
+  void normalizeKey(const char* field, unsigned char* key) const;
+  Status putTuple(char* slot, const Record & rec);
+  Status readTuple(char* slot);         // next tuple of source file
+  Status writeTuple(const char* slot);  // append to last run
+  Status createRun();                   // add an empty run to runs
+  Status finishRun();                   // close last run
+  Status mergeRuns(const int k);        // merge first k runs into one
   Status startScans();                  // start a scan on each sorted run
 
   typedef struct {
     string name;                        // name of run file
     HeapFileScan* inFile;               // ptr to input file
     InsertFileScan* outFile;		// ptr to output file
-    int valid;                          // TRUE if recPtr has a record
-    Record rec;
+    Record rec;                         // current record of run
     RID rid;                            // RID of current record of run
     RID mark;
   } RUN;
 
+  Status openRun(RUN & run);            // start scan, fetch first record
+  Status fetch(RUN & run);              // fetch next record of run
+
+  typedef struct {
+    int run;                            // run the tuple goes to
+    int slot;                           // workspace slot of the tuple
+  } HEAPITEM;
+
+  bool heapLess(const HEAPITEM & a, const HEAPITEM & b) const;
+  void siftUp(vector<HEAPITEM> & heap, int i) const;
+  void siftDown(vector<HEAPITEM> & heap, int i) const;
+
+  bool beats(const int a, const int b); // loser tree over runs
+  void buildTree(const int k);
+  void replay(const int k, const int leaf);
+
   vector<RUN> runs;                   // holds info about each sub-run
+  vector<int> tree;                     // loser tree, winner in tree[0]
+  int pending;                          // run to advance in next(), or -1
 
-  HeapFile* hfile;                   // source file to sort
   HeapFileScan* hfs;                   // source file to sort
   string fileName;                      // name of source file to sort
   Datatype type;                        // type of sort attribute
   int offset;                           // offset of sort attribute
   int length;                           // length of sort attribute
+  int dir;                              // 1 if ascending, -1 if descending
 
-  SORTREC* buffer;                      // in-memory sort buffer
+  char* tuples;                         // workspace slots
+  int recLen;                           // length of a tuple
+  int slotLen;                          // normalized key plus tuple
+  char* buffer;                         // in-memory sort items
+  char* tmpBuffer;                      // second buffer for sort items
+  int itemLen;                          // length of a sort item
   int maxItems;                         // max. # of items/tuples in buffer
   int numItems;                         // current # of items in buffer
+  MemGrant* grant;                      // workspace memory of run buffer
 };
 
 #endif
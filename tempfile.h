@@ -0,0 +1,66 @@
+#ifndef TEMPFILE_H
+#define TEMPFILE_H
+
+#include <string>
+#include <vector>
+#include <set>
+using namespace std;
+
+#include "error.h"
+
+// define if debug output wanted
+//#define DEBUGTEMP
+
+
+// The temporary file manager hands out the heap files that operators
+// spill to (sort runs, partitions, spilled hash tables). They are
+// placed in the directories listed in environment variable
+// MINIREL_TMPDIR (separated by colons, used round robin; /tmp if not
+// set) and named minirel.<pid>.<n>.<tag>, so that they cannot collide
+// with each other or with the files of another process.
+//
+// Files that operators leave behind (after an error) are destroyed
+// by cleanup() at the end of every statement; files of processes
+// that died are removed by removeOrphans() at startup.
+//
+// A file can be created compressed (see compressRecord), which costs
+// some CPU but cuts the temporary I/O. Operators report the pages
+// they spill, and the bytes of their records before and after
+// compression, with spilled(), which fails with SPILLQUOTA once a
+// statement has spilled more than the quota in MINIREL_SPILLQUOTA
+// (bytes, with an optional k, m or g suffix; no limit if not set).
+
+class TempFileMgr {
+ public:
+  TempFileMgr();
+
+  Status create(const string & tag, string & name, // new heap file
+		const bool compress);
+  Status destroy(const string & name);
+  Status spilled(const int pages,       // count pages written to a file
+		 const double rawBytes,
+		 const double storedBytes);
+
+  void cleanup();                       // destroy all files left
+  void removeOrphans();                 // files of dead processes
+
+  void clearStats();                    // start of a statement
+  double getSpilledBytes() const { return spilledBytes; }
+  int getFileCnt() const { return fileCnt; }
+  void printSelf();
+
+ private:
+  vector<string> dirs;                  // where files are placed
+  unsigned int nextDir;                 // round robin among dirs
+  int seq;                              // files created so far
+  double quota;                         // bytes per statement, 0 if none
+  double spilledBytes;                  // bytes spilled by statement
+  double rawBytes;                      // record bytes spilled
+  double storedBytes;                   // same after compression
+  int fileCnt;                          // files created by statement
+  set<string> live;                     // files not destroyed yet
+};
+
+extern TempFileMgr* tempFiles;
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "error.h"
+#include "page.h"
+
+// define if debug output wanted
+//#define DEBUGLOG
+
+class File;
+
+// The log manager keeps a write-ahead log of the changes to the heap
+// files of the database, in file wal.log of the database directory
+// (spill files are not logged: they do not outlive the process). A
+// change is logged as a redo record; the page it changes (and the
+// file's header page) is stamped with the record's LSN, the log
+// offset just past the record. The buffer manager writes a page only
+// after the log is durable up to the page's LSN, so that data pages
+// are written back lazily and never forced at commit.
+//
+// A statement commits by making the log durable up to its last
+// record. Commits are grouped: a flush writes and fdatasyncs all the
+// records appended so far, and whoever needs the log flushed while a
+// flush is in progress (another commit, the background writer of the
+// buffer manager) waits for it and is then most likely covered by it.
+// Environment variable MINIREL_GROUPCOMMIT (default 1) makes every
+// n-th statement flush the log for itself and those before it; the
+// statements in between return before they are durable.
+// MINIREL_CRASHAFTER=n, for testing recovery, ends the process right
+// after the n-th statement, without writing pages or a checkpoint.
+//
+// At startup the records in the log are redone on pages with older
+// LSNs. A checkpoint writes out every page of the buffer pool, syncs
+// the files and empties the log; one is taken after recovery, when
+// the log grows past LOGCHECKPOINT bytes and at shutdown.
+
+// kinds of log records
+enum LogType {
+  LOG_CREATE,     // new file: image of the header page
+  LOG_IMAGE,      // image of a data page
+  LOG_NEWPAGE,    // page appended to the file: image of the new page,
+		  // and the previous last page is linked to it
+  LOG_INSERT,     // record inserted into a page
+  LOG_DELETE      // record deleted from a page
+};
+
+// Header of a log record. It is followed by the name of the file and
+// by the data of the record: a page image for CREATE, IMAGE and
+// NEWPAGE, the record as stored for INSERT.
+
+struct LogRec {
+  int length;     // bytes of the record, this header included
+  int check;      // checksum of the bytes after this field
+  short type;     // LogType
+  short nameLen;  // bytes of the file name
+  int pageNo;     // page changed
+  int hdrPageNo;  // header page of the file
+  int arg[3];     // INSERT: raw and stored record length;
+		  // DELETE: slot #, raw and stored record length;
+		  // NEWPAGE: previous last page
+};
+
+class LogMgr {
+ public:
+  LogMgr(Status & status);              // open log, redo its records
+  ~LogMgr();
+
+  // append a record, returning its LSN
+  LSN append(const LogType type, const string & fileName,
+	     const int pageNo, const int hdrPageNo,
+	     const int arg0, const int arg1, const int arg2,
+	     const void* data, const int dataLen);
+
+  const Status flush(const LSN lsn);    // make log durable up to lsn
+  const Status commit();                // end of a statement
+  const Status checkpoint();            // write pages, empty the log
+
+  LSN endLSN() const { return nextLSN; }
+  int getRedone() const { return redone; }   // # records redone
+  int getFlushes() const { return flushes; } // # fdatasyncs of the log
+
+ private:
+  const Status recover();
+  const Status redo(const LogRec* rec, File* file, const char* data,
+		    const LSN lsn);
+  const Status redoHeader(File* file, const int hdrPageNo, const LSN lsn,
+			  const int recDelta, const int rawDelta,
+			  const int storedDelta, const int lastPage);
+  const Status writeHeader();
+
+  int fd;                               // log file
+  LSN baseLSN;                          // LSN of offset 0 of the file
+  LSN nextLSN;                          // LSN past the last record
+  LSN flushedLSN;                       // log durable up to here
+  vector<char> tail;                    // records not written yet
+  LSN tailLSN;                          // LSN of tail[0]
+  bool flushing;                        // a flush is in progress
+  int groupSize;                        // statements per flush
+  int uncommitted;                      // statements since last flush
+  int crashAfter;                       // statements until a crash, or 0
+  int flushes;                          // # of fdatasyncs of the log
+  int redone;                           // # of records redone at startup
+  pthread_mutex_t latch;
+  pthread_cond_t flushDone;
+};
+
+extern LogMgr* logMgr;
+
+#endif
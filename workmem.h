@@ -0,0 +1,83 @@
+#ifndef WORKMEM_H
+#define WORKMEM_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "page.h"
+
+// define if debug output wanted
+//#define DEBUGMEM
+
+
+// Usage record of one grant, kept from the time it is returned until
+// the statistics are cleared at the start of the next query.
+
+typedef struct {
+  string op;                            // operator that held the grant
+  int granted;                          // bytes granted
+  int peak;                             // max. bytes actually in use
+} GRANTSTAT;
+
+
+// The workspace memory manager hands out memory budgets (sort
+// buffers, hash tables, partition buffers) to operators from a
+// global limit, so that concurrent or nested operators together stay
+// within it. An operator asks for what it would like to have and for
+// the least it can work with; it gets as much of its wish as is
+// still available, but never less than its minimum (the limit is
+// overcommitted if need be, which is counted).
+
+class WorkMemMgr {
+ public:
+  WorkMemMgr(const int limit);          // limit in bytes
+
+  int grant(const int minBytes, const int wantBytes); // returns bytes
+  void release(const string & op, const int bytes, const int peak);
+
+  int getLimit() const { return limit; }
+  int getInUse() const { return inUse; }
+
+  const vector<GRANTSTAT> & getGrantStats() const { return grantStats; }
+  void clearStats();
+  void printSelf();
+
+ private:
+  int limit;                            // global limit in bytes
+  int inUse;                            // bytes currently granted
+  int peakInUse;                        // max. of inUse since clearStats
+  int overcommits;                      // # grants beyond the limit
+  vector<GRANTSTAT> grantStats;         // returned grants
+};
+
+extern WorkMemMgr* workMem;
+
+
+// A MemGrant holds a budget from workMem for the lifetime of an
+// operator (or until release() is called). The operator sizes its
+// buffers from size() or pages() and reports what it actually uses
+// with use(), which tracks the peak.
+
+class MemGrant {
+ public:
+  MemGrant(const string & op,           // name of operator
+	   const int minBytes,          // least it can work with
+	   const int wantBytes);        // most it could make use of
+  ~MemGrant();
+
+  int size() const { return bytes; }    // granted bytes
+  int pages() const { return bytes / PAGESIZE; } // granted pages
+  void use(const int nowBytes);         // report bytes now in use
+  int peak() const { return peakUsed; }
+  void release();                       // give the grant back early
+
+ private:
+  string op;
+  int bytes;
+  int peakUsed;
+  bool held;
+};
+
+#endif